@@ -0,0 +1,188 @@
+// # Goal to calculate permutation (ordinal-pattern) entropy of a price series, tick by tick
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <stdexcept>
+
+// Ordinal patterns are Lehmer-coded: for the `order` samples of a pattern in time order,
+// digit k counts the earlier samples that are larger than sample k (ties: earlier is smaller).
+// code = sum(digit_k * k!), so every pattern maps to a slot in [0, order!).
+// Sliding the pattern one step only drops the oldest sample and ranks the newest against the
+// rest, so the next code comes from a precomputed (code, rank) -> code table instead of a sort.
+class PermutationEntropy {
+public:
+    PermutationEntropy(int order = 3, int delay = 1, size_t window = 0)
+        : order_(order), delay_(delay), window_(window) {
+        if (order < 3 || order > 7) {
+            throw std::invalid_argument("permutation entropy order must be in [3, 7]");
+        }
+        if (delay < 1) {
+            throw std::invalid_argument("permutation entropy delay must be >= 1");
+        }
+
+        num_patterns_ = 1;
+        for (int k = 2; k <= order_; ++k) num_patterns_ *= k;
+
+        build_transitions();
+
+        history_.assign(static_cast<size_t>(order_ - 1) * delay_ + 1, 0.0);
+        last_codes_.assign(delay_, 0);
+        counts_.assign(num_patterns_, 0);
+        if (window_ > 0) {
+            recent_.assign(window_, 0);
+            nlog2n_.resize(window_ + 1);
+            for (size_t n = 0; n <= window_; ++n) nlog2n_[n] = n > 0 ? n * std::log2((double)n) : 0.0;
+        }
+    }
+
+    // Feed one tick. Returns true once the tick completes an ordinal pattern that was counted.
+    bool push(double price) {
+        const size_t span = history_.size();
+        history_[head_] = price;
+        size_t newest = head_;
+        head_ = (head_ + 1) % span;
+        ++ticks_;
+        if (ticks_ < span) return false;
+
+        // Rank the new sample against the order-1 samples it shares with the pattern `delay` ticks ago.
+        int larger = 0;
+        for (int k = 1; k < order_; ++k) {
+            size_t idx = (newest + span - static_cast<size_t>(k) * delay_) % span;
+            if (history_[idx] > price) ++larger;
+        }
+
+        size_t chain = (ticks_ - span) % delay_;
+        uint16_t code;
+        if (ticks_ - span < static_cast<size_t>(delay_)) {
+            code = encode_from_history(newest);
+        } else {
+            code = transitions_[static_cast<size_t>(last_codes_[chain]) * order_ + larger];
+        }
+        last_codes_[chain] = code;
+
+        if (window_ > 0 && counted_ == window_) {
+            uint16_t evicted = recent_[recent_head_];
+            sum_nlogn_ -= nlog2n_[counts_[evicted]] - nlog2n_[counts_[evicted] - 1];
+            counts_[evicted]--;
+            counted_--;
+        }
+        if (window_ > 0) {
+            recent_[recent_head_] = code;
+            recent_head_ = (recent_head_ + 1) % window_;
+            sum_nlogn_ += nlog2n_[counts_[code] + 1] - nlog2n_[counts_[code]];
+        } else {
+            uint64_t n = counts_[code];
+            sum_nlogn_ += (n + 1) * std::log2((double)(n + 1)) - (n > 0 ? n * std::log2((double)n) : 0.0);
+        }
+        counts_[code]++;
+        counted_++;
+        return true;
+    }
+
+    // Shannon entropy of the pattern distribution in bits: log2(N) - sum(n_i * log2(n_i)) / N
+    double entropy() const {
+        if (counted_ == 0) return 0.0;
+        double n = (double)counted_;
+        double h = std::log2(n) - sum_nlogn_ / n;
+        return h > 0.0 ? h : 0.0;
+    }
+
+    // Entropy scaled to [0, 1] by the maximum log2(order!)
+    double normalized_entropy() const {
+        return entropy() / std::log2((double)num_patterns_);
+    }
+
+    void reset() {
+        std::fill(counts_.begin(), counts_.end(), 0);
+        std::fill(last_codes_.begin(), last_codes_.end(), 0);
+        head_ = 0;
+        ticks_ = 0;
+        counted_ = 0;
+        recent_head_ = 0;
+        sum_nlogn_ = 0.0;
+    }
+
+    int order() const { return order_; }
+    int delay() const { return delay_; }
+    size_t window() const { return window_; }
+    size_t num_patterns() const { return num_patterns_; }
+    size_t patterns_counted() const { return counted_; }
+    const std::vector<uint64_t>& counts() const { return counts_; }
+
+private:
+    int order_;
+    int delay_;
+    size_t window_;
+    size_t num_patterns_ = 0;
+
+    std::vector<uint16_t> transitions_;  // num_patterns_ x order_
+    std::vector<double> history_;        // ring of the last (order-1)*delay+1 ticks
+    std::vector<uint16_t> last_codes_;   // most recent code on each of the `delay` interleaved chains
+    std::vector<uint64_t> counts_;       // flat pattern histogram
+    std::vector<uint16_t> recent_;       // ring of counted codes (sliding window only)
+    std::vector<double> nlog2n_;         // n * log2(n) for n in [0, window]
+
+    size_t head_ = 0;
+    size_t ticks_ = 0;
+    size_t counted_ = 0;
+    size_t recent_head_ = 0;
+    double sum_nlogn_ = 0.0;
+
+    static uint16_t encode_ranks(const std::vector<int>& ranks) {
+        uint32_t code = 0, radix = 1;
+        for (size_t k = 1; k < ranks.size(); ++k) {
+            radix *= static_cast<uint32_t>(k);
+            uint32_t digit = 0;
+            for (size_t j = 0; j < k; ++j) {
+                if (ranks[j] > ranks[k]) ++digit;
+            }
+            code += digit * radix;
+        }
+        return static_cast<uint16_t>(code);
+    }
+
+    // Only used for the first pattern on each chain; every later one goes through the table.
+    uint16_t encode_from_history(size_t newest) const {
+        const size_t span = history_.size();
+        uint32_t code = 0, radix = 1;
+        for (int k = 1; k < order_; ++k) {
+            radix *= static_cast<uint32_t>(k);
+            size_t ik = (newest + span - static_cast<size_t>(order_ - 1 - k) * delay_) % span;
+            uint32_t digit = 0;
+            for (int j = 0; j < k; ++j) {
+                size_t ij = (newest + span - static_cast<size_t>(order_ - 1 - j) * delay_) % span;
+                if (history_[ij] > history_[ik]) ++digit;
+            }
+            code += digit * radix;
+        }
+        return static_cast<uint16_t>(code);
+    }
+
+    void build_transitions() {
+        transitions_.assign(num_patterns_ * order_, 0);
+        std::vector<int> ranks(order_), next(order_);
+        for (int i = 0; i < order_; ++i) ranks[i] = i;
+        do {
+            uint16_t from = encode_ranks(ranks);
+            for (int larger = 0; larger < order_; ++larger) {
+                // Drop the oldest sample, re-rank the survivors, and slot the newest below `larger` of them.
+                int new_rank = (order_ - 1) - larger;
+                for (int k = 1; k < order_; ++k) {
+                    int r = ranks[k] - (ranks[k] > ranks[0] ? 1 : 0);
+                    next[k - 1] = r >= new_rank ? r + 1 : r;
+                }
+                next[order_ - 1] = new_rank;
+                transitions_[static_cast<size_t>(from) * order_ + larger] = encode_ranks(next);
+            }
+        } while (std::next_permutation(ranks.begin(), ranks.end()));
+    }
+};
+
+// Batch permutation entropy over a whole series, in bits
+double permutation_entropy(const std::vector<double>& prices, int order = 3, int delay = 1) {
+    PermutationEntropy pe(order, delay);
+    for (double p : prices) pe.push(p);
+    return pe.entropy();
+}
@@ -0,0 +1,285 @@
+// # Goal to put confidence intervals and p-values on the entropy-volatility correlation
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+struct ResamplingConfig {
+    size_t bootstrap_resamples = 10000;
+    size_t permutation_resamples = 10000;
+    size_t block_length = 0;   // 0 = round(n^(1/3))
+    double confidence = 0.95;
+    uint64_t seed = 42;
+    unsigned threads = 0;      // 0 = all cores
+};
+
+struct SignificanceResult {
+    double r = 0.0;
+    double ci_low = 0.0;
+    double ci_high = 0.0;
+    double std_error = 0.0;
+    double p_value = 1.0;      // two-sided, H0: no association
+    size_t block_length = 0;
+    size_t bootstrap_resamples = 0;
+    size_t permutation_resamples = 0;
+};
+
+double pearson_correlation(const std::vector<double>& x, const std::vector<double>& y) {
+    size_t n = std::min(x.size(), y.size());
+    if (n < 2) return 0.0;
+    double mean_x = 0.0, mean_y = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        mean_x += x[i];
+        mean_y += y[i];
+    }
+    mean_x /= n;
+    mean_y /= n;
+    double numerator = 0.0, denom_x = 0.0, denom_y = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        double dx = x[i] - mean_x;
+        double dy = y[i] - mean_y;
+        numerator += dx * dy;
+        denom_x += dx * dx;
+        denom_y += dy * dy;
+    }
+    if (denom_x <= 0.0 || denom_y <= 0.0) return 0.0;
+    return numerator / std::sqrt(denom_x * denom_y);
+}
+
+namespace resampling_detail {
+
+// Resamples are handed out in fixed chunks, each with its own RNG stream derived from
+// (seed, test, chunk). Results land at their resample index, so the output is identical
+// for any thread count.
+constexpr size_t CHUNK = 256;
+
+inline uint64_t splitmix64(uint64_t z) {
+    z += 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// xoshiro256**: 32 bytes of state, cheap to seed once per chunk and a few cycles per draw
+struct Xoshiro256 {
+    using result_type = uint64_t;
+    uint64_t s[4];
+
+    explicit Xoshiro256(uint64_t seed) {
+        for (auto& word : s) {
+            seed = splitmix64(seed);
+            word = seed;
+        }
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~uint64_t(0); }
+
+    result_type operator()() {
+        uint64_t result = rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+private:
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+};
+
+inline Xoshiro256 chunk_rng(uint64_t seed, uint64_t test, uint64_t chunk) {
+    return Xoshiro256(splitmix64(seed ^ (test << 56)) + chunk);
+}
+
+// Index in [0, range) from the high bits of rng() * range; bias is range / 2^64 (range / 2^32 on
+// the 32-bit path), far below resampling noise
+inline size_t bounded(Xoshiro256& rng, size_t range) {
+    uint64_t x = rng();
+    uint64_t r = range;
+    if (r <= 0xffffffffULL) return static_cast<size_t>(((x >> 32) * r) >> 32);
+    uint64_t x_lo = x & 0xffffffffULL, x_hi = x >> 32;
+    uint64_t r_lo = r & 0xffffffffULL, r_hi = r >> 32;
+    uint64_t lo_lo = x_lo * r_lo, hi_lo = x_hi * r_lo, lo_hi = x_lo * r_hi, hi_hi = x_hi * r_hi;
+    uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xffffffffULL) + lo_hi;
+    return static_cast<size_t>(hi_hi + (hi_lo >> 32) + (cross >> 32));
+}
+
+template <typename Worker>
+void run_chunks(size_t resamples, unsigned threads, Worker worker) {
+    size_t chunks = (resamples + CHUNK - 1) / CHUNK;
+    if (chunks == 0) return;
+    std::atomic<size_t> next{0};
+    auto loop = [&]() {
+        auto state = worker.make_state();
+        for (size_t c = next.fetch_add(1); c < chunks; c = next.fetch_add(1)) {
+            worker.run(state, c, c * CHUNK, std::min(resamples, (c + 1) * CHUNK));
+        }
+    };
+    unsigned used = static_cast<unsigned>(std::min<size_t>(threads, chunks));
+    std::vector<std::thread> pool;
+    pool.reserve(used > 0 ? used - 1 : 0);
+    for (unsigned t = 1; t < used; ++t) pool.emplace_back(loop);
+    loop();
+    for (auto& th : pool) th.join();
+}
+
+// Circular block bootstrap of (x, y) pairs; sums are accumulated straight from the
+// drawn block offsets, so nothing is copied or allocated per resample.
+struct BootstrapWorker {
+    const std::vector<double>& xc;
+    const std::vector<double>& yc;
+    size_t block;
+    uint64_t seed;
+    std::vector<double>& out;
+
+    struct State {};
+    State make_state() const { return {}; }
+
+    void run(State&, size_t chunk, size_t begin, size_t end) const {
+        const size_t n = xc.size();
+        auto rng = chunk_rng(seed, 0, chunk);
+        for (size_t b = begin; b < end; ++b) {
+            double sx = 0.0, sy = 0.0, sxx = 0.0, syy = 0.0, sxy = 0.0;
+            size_t filled = 0;
+            while (filled < n) {
+                size_t i = bounded(rng, n);
+                size_t len = std::min(block, n - filled);
+                for (size_t k = 0; k < len; ++k) {
+                    double vx = xc[i], vy = yc[i];
+                    sx += vx;
+                    sy += vy;
+                    sxx += vx * vx;
+                    syy += vy * vy;
+                    sxy += vx * vy;
+                    if (++i == n) i = 0;
+                }
+                filled += len;
+            }
+            double cov = sxy - sx * sy / n;
+            double var_x = sxx - sx * sx / n;
+            double var_y = syy - sy * sy / n;
+            out[b] = (var_x > 0.0 && var_y > 0.0) ? cov / std::sqrt(var_x * var_y) : 0.0;
+        }
+    }
+};
+
+// Permutation test by circular shift: y is rotated against x by a lag in [1, n-1]. Unlike an
+// element shuffle this keeps the autocorrelation of both series, which windowed entropy and
+// volatility have. Means and variances are shift invariant, so each resample is one dot product.
+// With exhaustive set, resample b uses lag b + 1 and every lag is visited once.
+struct ShiftWorker {
+    const std::vector<double>& xc;
+    const std::vector<double>& yc;
+    double threshold;  // |sum(xc * yc)| of the observed data
+    uint64_t seed;
+    bool exhaustive;
+    std::vector<size_t>& exceed;
+
+    struct State {};
+    State make_state() const { return {}; }
+
+    void run(State&, size_t chunk, size_t begin, size_t end) const {
+        const size_t n = xc.size();
+        auto rng = chunk_rng(seed, 1, chunk);
+        size_t count = 0;
+        for (size_t b = begin; b < end; ++b) {
+            size_t lag = exhaustive ? b + 1 : 1 + bounded(rng, n - 1);
+            double dot = 0.0;
+            for (size_t i = 0, j = lag; i < n; ++i) {
+                dot += xc[i] * yc[j];
+                if (++j == n) j = 0;
+            }
+            if (std::fabs(dot) >= threshold) ++count;
+        }
+        exceed[chunk] = count;
+    }
+};
+
+}  // namespace resampling_detail
+
+// Block-bootstrap percentile CI and circular-shift permutation p-value for Pearson r between two series
+SignificanceResult correlation_significance(const std::vector<double>& x, const std::vector<double>& y,
+                                            const ResamplingConfig& config = ResamplingConfig()) {
+    using namespace resampling_detail;
+    if (x.size() != y.size()) {
+        throw std::invalid_argument("correlation_significance: series lengths differ");
+    }
+    if (x.size() < 3) {
+        throw std::invalid_argument("correlation_significance: need at least 3 observations");
+    }
+    if (!(config.confidence > 0.0 && config.confidence < 1.0)) {
+        throw std::invalid_argument("correlation_significance: confidence must be in (0, 1)");
+    }
+
+    const size_t n = x.size();
+    SignificanceResult result;
+    result.r = pearson_correlation(x, y);
+    result.block_length = config.block_length > 0
+        ? std::min(config.block_length, n)
+        : std::max<size_t>(1, static_cast<size_t>(std::lround(std::cbrt((double)n))));
+    result.bootstrap_resamples = config.bootstrap_resamples;
+    result.permutation_resamples = config.permutation_resamples;
+
+    unsigned threads = config.threads > 0 ? config.threads : std::thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+
+    double mean_x = 0.0, mean_y = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        mean_x += x[i];
+        mean_y += y[i];
+    }
+    mean_x /= n;
+    mean_y /= n;
+    std::vector<double> xc(n), yc(n);
+    double observed_dot = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        xc[i] = x[i] - mean_x;
+        yc[i] = y[i] - mean_y;
+        observed_dot += xc[i] * yc[i];
+    }
+
+    if (config.bootstrap_resamples > 0) {
+        std::vector<double> rs(config.bootstrap_resamples);
+        run_chunks(rs.size(), threads, BootstrapWorker{xc, yc, result.block_length, config.seed, rs});
+
+        double mean_r = 0.0;
+        for (double r : rs) mean_r += r;
+        mean_r /= rs.size();
+        double var_r = 0.0;
+        for (double r : rs) var_r += (r - mean_r) * (r - mean_r);
+        result.std_error = rs.size() > 1 ? std::sqrt(var_r / (rs.size() - 1)) : 0.0;
+
+        double alpha = 1.0 - config.confidence;
+        size_t lo = static_cast<size_t>(std::floor(alpha / 2.0 * (rs.size() - 1)));
+        size_t hi = static_cast<size_t>(std::ceil((1.0 - alpha / 2.0) * (rs.size() - 1)));
+        std::nth_element(rs.begin(), rs.begin() + lo, rs.end());
+        result.ci_low = rs[lo];
+        std::nth_element(rs.begin() + lo, rs.begin() + hi, rs.end());
+        result.ci_high = rs[hi];
+    }
+
+    if (config.permutation_resamples > 0) {
+        // Only n - 1 distinct lags exist; if that many were asked for, enumerate them exactly
+        bool exhaustive = n - 1 <= config.permutation_resamples;
+        size_t resamples = exhaustive ? n - 1 : config.permutation_resamples;
+        result.permutation_resamples = resamples;
+        size_t chunks = (resamples + CHUNK - 1) / CHUNK;
+        std::vector<size_t> exceed(chunks, 0);
+        // Tolerance keeps resamples that reproduce the observed pairing from missing by rounding
+        double threshold = std::fabs(observed_dot) * (1.0 - 1e-12);
+        run_chunks(resamples, threads, ShiftWorker{xc, yc, threshold, config.seed, exhaustive, exceed});
+        size_t count = 0;
+        for (size_t c : exceed) count += c;
+        result.p_value = (double)(count + 1) / (resamples + 1);
+    }
+
+    return result;
+}
@@ -0,0 +1,137 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <iomanip>
+#include <cassert>
+#include <cmath>
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <map>
+#include "../permutation-entropy.cpp"
+
+// Reference implementation: sort every pattern, count rank vectors in a map
+double reference_permutation_entropy(const std::vector<double>& prices, size_t begin, size_t end, int order, int delay) {
+    std::map<std::vector<int>, int> counts;
+    int total = 0;
+    size_t span = static_cast<size_t>(order - 1) * delay;
+    for (size_t t = begin; t + span < end; ++t) {
+        std::vector<int> idx(order);
+        std::iota(idx.begin(), idx.end(), 0);
+        std::stable_sort(idx.begin(), idx.end(), [&](int a, int b) {
+            return prices[t + a * delay] < prices[t + b * delay];
+        });
+        counts[idx]++;
+        total++;
+    }
+    double entropy = 0.0;
+    for (const auto& pair : counts) {
+        double p = (double)pair.second / total;
+        entropy -= p * std::log2(p);
+    }
+    return entropy;
+}
+
+std::vector<double> random_walk(size_t n, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> step(0.0, 0.05);
+    std::vector<double> prices(n);
+    double price = 681.27;
+    for (auto& p : prices) {
+        price += step(rng);
+        p = std::round(price * 100.0) / 100.0; // cent ticks so ties actually occur
+    }
+    return prices;
+}
+
+int main() {
+    std::cout << "=== Permutation Entropy Test ===\n\n";
+    std::cout << std::fixed << std::setprecision(6);
+
+    int passed_tests = 0;
+    int total_tests = 0;
+    auto check = [&](const std::string& name, bool ok) {
+        total_tests++;
+        if (ok) passed_tests++;
+        std::cout << "  " << (ok ? "✓ PASSED: " : "✗ FAILED: ") << name << "\n";
+    };
+
+    std::cout << "Test: Monotonic series (single pattern)\n";
+    std::vector<double> rising(50);
+    std::iota(rising.begin(), rising.end(), 600.0);
+    double h_rising = permutation_entropy(rising, 4, 1);
+    std::cout << "  Entropy: " << h_rising << " bits\n";
+    check("Monotonic prices yield zero entropy", h_rising < 1e-12);
+
+    std::cout << "Test: Flat series (ties resolve by time)\n";
+    std::vector<double> flat(50, 681.27);
+    check("Constant prices yield zero entropy", permutation_entropy(flat, 3, 1) < 1e-12);
+
+    std::cout << "Test: Too few ticks\n";
+    PermutationEntropy short_pe(5, 2);
+    for (int i = 0; i < 8; ++i) short_pe.push(600.0 + i);
+    check("No pattern before (order-1)*delay+1 ticks", short_pe.patterns_counted() == 0 && short_pe.entropy() == 0.0);
+
+    std::cout << "Test: Alternating series (two patterns, equal frequency)\n";
+    std::vector<double> zigzag;
+    for (int i = 0; i < 102; ++i) zigzag.push_back(i % 2 ? 681.5 : 681.0);
+    double h_zigzag = permutation_entropy(zigzag, 3, 1);
+    std::cout << "  Entropy: " << h_zigzag << " bits\n";
+    check("Up/down alternation yields 1 bit", std::fabs(h_zigzag - 1.0) < 1e-9);
+
+    std::cout << "Test: Streaming codes match sort-based reference (orders 3-7, delays 1-3)\n";
+    auto prices = random_walk(3000, 42);
+    bool all_match = true;
+    for (int order = 3; order <= 7; ++order) {
+        for (int delay = 1; delay <= 3; ++delay) {
+            double streamed = permutation_entropy(prices, order, delay);
+            double reference = reference_permutation_entropy(prices, 0, prices.size(), order, delay);
+            if (std::fabs(streamed - reference) > 1e-9) {
+                all_match = false;
+                std::cout << "    order=" << order << " delay=" << delay
+                          << " streamed=" << streamed << " reference=" << reference << "\n";
+            }
+        }
+    }
+    check("Lehmer-code updates agree with sorting every pattern", all_match);
+
+    std::cout << "Test: Sliding window matches reference on each window\n";
+    const int order = 4, delay = 2;
+    const size_t window = 200;
+    const size_t span = static_cast<size_t>(order - 1) * delay;
+    PermutationEntropy sliding(order, delay, window);
+    bool window_match = true;
+    for (size_t t = 0; t < prices.size(); ++t) {
+        if (!sliding.push(prices[t])) continue;
+        size_t counted = sliding.patterns_counted();
+        size_t begin = t + 1 - span - counted;
+        double reference = reference_permutation_entropy(prices, begin, t + 1, order, delay);
+        if (std::fabs(sliding.entropy() - reference) > 1e-9) window_match = false;
+        if (counted > window) window_match = false;
+    }
+    check("Sliding window entropy tracks the last " + std::to_string(window) + " patterns", window_match);
+
+    std::cout << "Test: Normalized entropy bounds\n";
+    PermutationEntropy norm(3, 1);
+    for (double p : prices) norm.push(p);
+    std::cout << "  Normalized entropy: " << norm.normalized_entropy() << "\n";
+    check("Random walk normalized entropy in (0.9, 1]", norm.normalized_entropy() > 0.9 && norm.normalized_entropy() <= 1.0);
+
+    std::cout << "Test: Invalid parameters\n";
+    bool rejected = true;
+    for (auto params : std::vector<std::pair<int, int>>{{2, 1}, {8, 1}, {3, 0}}) {
+        try {
+            PermutationEntropy bad(params.first, params.second);
+            rejected = false;
+        } catch (const std::invalid_argument&) {
+        }
+    }
+    check("Order outside [3, 7] or delay < 1 throws", rejected);
+
+    std::cout << "\n=== Permutation Entropy Test Summary ===\n";
+    std::cout << "Tests passed: " << passed_tests << "/" << total_tests << "\n";
+    assert(passed_tests == total_tests);
+    std::cout << "✓ ALL PERMUTATION ENTROPY TESTS PASSED\n";
+
+    return 0;
+}
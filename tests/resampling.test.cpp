@@ -0,0 +1,143 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <iomanip>
+#include <cassert>
+#include <cmath>
+#include <random>
+#include <chrono>
+#include "../resampling.cpp"
+
+// Entropy/volatility-like pair: AR(1) entropy with volatility = a*entropy + noise
+void correlated_series(size_t n, double slope, unsigned seed, std::vector<double>& entropy, std::vector<double>& volatility) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> noise(0.0, 1.0);
+    entropy.resize(n);
+    volatility.resize(n);
+    double e = 1.0;
+    for (size_t i = 0; i < n; ++i) {
+        e = 1.0 + 0.6 * (e - 1.0) + 0.2 * noise(rng);
+        entropy[i] = e;
+        volatility[i] = 3.0 + slope * e + noise(rng);
+    }
+}
+
+// Two independent AR(1) series: no association, but both strongly autocorrelated
+void independent_ar1(size_t n, double phi, unsigned seed, std::vector<double>& x, std::vector<double>& y) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> noise(0.0, 1.0);
+    x.resize(n);
+    y.resize(n);
+    double a = 0.0, b = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        a = phi * a + noise(rng);
+        b = phi * b + noise(rng);
+        x[i] = a;
+        y[i] = b;
+    }
+}
+
+int main() {
+    std::cout << "=== Resampling Significance Test ===\n\n";
+    std::cout << std::fixed << std::setprecision(4);
+
+    int passed_tests = 0;
+    int total_tests = 0;
+    auto check = [&](const std::string& name, bool ok) {
+        total_tests++;
+        if (ok) passed_tests++;
+        std::cout << "  " << (ok ? "✓ PASSED: " : "✗ FAILED: ") << name << "\n";
+    };
+
+    std::vector<double> entropy, volatility;
+
+    std::cout << "Test: Strong negative association (n=300)\n";
+    correlated_series(300, -4.0, 42, entropy, volatility);
+    ResamplingConfig config;
+    auto strong = correlation_significance(entropy, volatility, config);
+    std::cout << "  r = " << strong.r << "  95% CI [" << strong.ci_low << ", " << strong.ci_high << "]"
+              << "  SE = " << strong.std_error << "  p = " << strong.p_value
+              << "  (block length " << strong.block_length << ")\n";
+    check("Correlation matches direct Pearson r", std::fabs(strong.r - pearson_correlation(entropy, volatility)) < 1e-12);
+    check("CI brackets the observed r", strong.ci_low <= strong.r && strong.r <= strong.ci_high);
+    check("CI excludes zero", strong.ci_high < 0.0);
+    check("All n-1 shifts enumerated", strong.permutation_resamples == entropy.size() - 1);
+    check("p-value at its floor 1/n", std::fabs(strong.p_value - 1.0 / entropy.size()) < 1e-12);
+
+    std::cout << "Test: No association (n=300)\n";
+    correlated_series(300, 0.0, 7, entropy, volatility);
+    auto null_case = correlation_significance(entropy, volatility, config);
+    std::cout << "  r = " << null_case.r << "  95% CI [" << null_case.ci_low << ", " << null_case.ci_high << "]"
+              << "  p = " << null_case.p_value << "\n";
+    check("CI covers zero", null_case.ci_low < 0.0 && null_case.ci_high > 0.0);
+    check("Not significant at 5%", null_case.p_value > 0.05);
+
+    std::cout << "Test: Null calibration on autocorrelated series (AR(1), phi=0.9, n=300)\n";
+    const int null_runs = 40;
+    int rejections = 0;
+    ResamplingConfig null_config;
+    null_config.bootstrap_resamples = 0;
+    null_config.permutation_resamples = 2000;
+    for (int run = 0; run < null_runs; ++run) {
+        independent_ar1(300, 0.9, 1000 + run, entropy, volatility);
+        if (correlation_significance(entropy, volatility, null_config).p_value < 0.05) rejections++;
+    }
+    double rejection_rate = (double)rejections / null_runs;
+    std::cout << "  Rejection rate at 5%: " << rejection_rate << " (" << rejections << "/" << null_runs << ")\n";
+    check("Rejection rate stays near the nominal 5%", rejection_rate <= 0.125);
+
+    std::cout << "Test: Reproducible across thread counts\n";
+    correlated_series(300, 0.0, 7, entropy, volatility);
+    ResamplingConfig sampled = config;
+    sampled.permutation_resamples = 200;  // fewer than n-1, so shifts are drawn at random
+    ResamplingConfig one_thread = sampled, many_threads = sampled;
+    one_thread.threads = 1;
+    many_threads.threads = 8;
+    auto a = correlation_significance(entropy, volatility, one_thread);
+    auto b = correlation_significance(entropy, volatility, many_threads);
+    check("Identical CI and p-value for 1 and 8 threads",
+          a.ci_low == b.ci_low && a.ci_high == b.ci_high && a.std_error == b.std_error && a.p_value == b.p_value);
+    ResamplingConfig other_seed = sampled;
+    other_seed.seed = 43;
+    auto c = correlation_significance(entropy, volatility, other_seed);
+    check("Different seed gives a different draw", c.ci_low != a.ci_low || c.p_value != a.p_value);
+
+    std::cout << "Test: Invalid input\n";
+    bool rejected = true;
+    try {
+        correlation_significance({1.0, 2.0, 3.0}, {1.0, 2.0});
+        rejected = false;
+    } catch (const std::invalid_argument&) {
+    }
+    try {
+        correlation_significance({1.0, 2.0}, {1.0, 2.0});
+        rejected = false;
+    } catch (const std::invalid_argument&) {
+    }
+    check("Mismatched or too-short series throw", rejected);
+
+    std::cout << "Test: Constant series\n";
+    std::vector<double> flat(50, 1.5), ramp(50);
+    for (size_t i = 0; i < ramp.size(); ++i) ramp[i] = (double)i;
+    auto degenerate = correlation_significance(flat, ramp);
+    check("Zero variance yields r = 0 and p = 1", degenerate.r == 0.0 && degenerate.p_value == 1.0);
+
+    std::cout << "\n=== Throughput ===\n";
+    correlated_series(5000, -1.0, 1, entropy, volatility);
+    ResamplingConfig heavy;
+    heavy.bootstrap_resamples = 100000;
+    heavy.permutation_resamples = 100000;  // capped at the n-1 distinct shifts
+    auto start = std::chrono::steady_clock::now();
+    auto big = correlation_significance(entropy, volatility, heavy);
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "n = 5000, 100k bootstrap resamples + " << big.permutation_resamples << " shifts on "
+              << std::thread::hardware_concurrency() << " core(s): " << secs << " s\n";
+    std::cout << "r = " << big.r << "  95% CI [" << big.ci_low << ", " << big.ci_high << "]  p = " << big.p_value << "\n";
+
+    std::cout << "\n=== Resampling Test Summary ===\n";
+    std::cout << "Tests passed: " << passed_tests << "/" << total_tests << "\n";
+    assert(passed_tests == total_tests);
+    std::cout << "✓ ALL RESAMPLING TESTS PASSED\n";
+
+    return 0;
+}
@@ -0,0 +1,185 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <iomanip>
+#include <cassert>
+#include <cmath>
+#include <random>
+#include <chrono>
+#include <filesystem>
+#include "../tick-archive.cpp"
+
+namespace fs = std::filesystem;
+
+struct SymbolTicks {
+    std::string symbol;
+    std::vector<Tick> ticks;
+};
+
+// One session of cent-resolution random-walk quotes, ~10 ticks/s with jitter
+std::vector<SymbolTicks> synthetic_session(int64_t open_us, int64_t close_us, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::exponential_distribution<double> gap(10.0);
+    std::normal_distribution<double> step(0.0, 0.02);
+    std::vector<SymbolTicks> session = {{"SPY", {}}, {"QQQ", {}}, {"AAPL", {}}, {"TSLA", {}}};
+    double start_prices[] = {681.27, 600.64, 261.73, 417.07};
+    for (size_t s = 0; s < session.size(); ++s) {
+        double price = start_prices[s];
+        for (int64_t t = open_us; t < close_us; t += 1 + static_cast<int64_t>(gap(rng) * 1e6)) {
+            price += step(rng);
+            session[s].ticks.push_back({t, std::round(price * 100.0) / 100.0});
+        }
+    }
+    return session;
+}
+
+int main() {
+    std::cout << "=== Tick Archive Test ===\n\n";
+    std::cout << std::fixed << std::setprecision(3);
+
+    int passed_tests = 0;
+    int total_tests = 0;
+    auto check = [&](const std::string& name, bool ok) {
+        total_tests++;
+        if (ok) passed_tests++;
+        std::cout << "  " << (ok ? "✓ PASSED: " : "✗ FAILED: ") << name << "\n";
+    };
+
+    fs::path dir = fs::temp_directory_path() / "shannon_tick_archive_test";
+    fs::create_directories(dir);
+    std::string path = (dir / "session.ticks").string();
+
+    const int64_t open_us = parse_timestamp_us("2026-02-16 15:30:00");
+    const int64_t close_us = parse_timestamp_us("2026-02-16 22:00:00");
+    auto session = synthetic_session(open_us, close_us, 42);
+
+    // Interleave symbols by time, the way a live multi-symbol feed arrives
+    struct Row { int64_t ts; size_t symbol; double price; };
+    std::vector<Row> feed;
+    size_t total_ticks = 0;
+    for (size_t s = 0; s < session.size(); ++s) {
+        for (const auto& t : session[s].ticks) feed.push_back({t.timestamp_us, s, t.price});
+        total_ticks += session[s].ticks.size();
+    }
+    std::stable_sort(feed.begin(), feed.end(), [](const Row& a, const Row& b) { return a.ts < b.ts; });
+
+    auto write_start = std::chrono::steady_clock::now();
+    {
+        TickArchiveWriter writer(path);
+        for (const auto& row : feed) writer.append(session[row.symbol].symbol, row.ts, row.price);
+    }
+    double write_secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - write_start).count();
+
+    uint64_t file_bytes = fs::file_size(path);
+    std::cout << "Archived " << total_ticks << " ticks (4 symbols) in " << file_bytes << " bytes: "
+              << (double)file_bytes / total_ticks << " bytes/tick, written in " << write_secs << " s\n\n";
+
+    TickArchiveReader reader(path);
+
+    std::cout << "Test: Round trip\n";
+    bool exact = true;
+    for (const auto& s : session) {
+        auto decoded = reader.read_all(s.symbol);
+        if (decoded.size() != s.ticks.size()) {
+            exact = false;
+            continue;
+        }
+        for (size_t i = 0; i < decoded.size(); ++i) {
+            if (decoded[i].timestamp_us != s.ticks[i].timestamp_us ||
+                std::fabs(decoded[i].price - s.ticks[i].price) > 1e-9) {
+                exact = false;
+            }
+        }
+    }
+    check("Every symbol decodes to the exact ticks written", exact);
+    check("Archive is under 8 bytes/tick", (double)file_bytes / total_ticks < 8.0);
+
+    std::cout << "Test: Range query SPY 15:30-15:35\n";
+    int64_t from = parse_timestamp_us("2026-02-16 15:30:00");
+    int64_t to = parse_timestamp_us("2026-02-16 15:35:00");
+    size_t blocks_before = reader.blocks_decoded();
+    auto query_start = std::chrono::steady_clock::now();
+    auto window = reader.query("SPY", from, to);
+    double query_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - query_start).count();
+    size_t blocks_touched = reader.blocks_decoded() - blocks_before;
+    size_t expected = 0;
+    bool in_range = true;
+    for (const auto& t : session[0].ticks) {
+        if (t.timestamp_us >= from && t.timestamp_us <= to) expected++;
+    }
+    for (const auto& t : window) {
+        if (t.timestamp_us < from || t.timestamp_us > to) in_range = false;
+    }
+    std::cout << "  " << window.size() << " ticks from " << blocks_touched << "/" << reader.blocks().size()
+              << " blocks in " << query_ms << " ms\n";
+    check("Range query returns exactly the ticks in range", window.size() == expected && in_range);
+    check("Range query decodes only overlapping blocks", blocks_touched <= 2);
+
+    std::cout << "Test: Empty ranges\n";
+    check("Unknown symbol returns nothing", reader.query("MSFT", from, to).empty());
+    check("Range before the session returns nothing",
+          reader.query("SPY", parse_timestamp_us("2026-02-16 09:00:00"), parse_timestamp_us("2026-02-16 09:05:00")).empty());
+
+    std::cout << "Test: Accumulator CSV import\n";
+    std::string csv_path = (dir / "spy_live_data.csv").string();
+    {
+        std::ofstream csv(csv_path);
+        csv << "Timestamp,Price,High,Low,Open,PrevClose\n";
+        csv << "2026-02-16 15:30:58,681.27,681.7,677.52,681.27,681.75\n";
+        csv << "2026-02-16 15:31:13,681.31,681.7,677.52,681.27,681.75\n";
+        csv << "2026-02-16 15:31:29,681.19,681.7,677.52,681.27,681.75\n";
+    }
+    std::string csv_archive = (dir / "spy_live_data.ticks").string();
+    size_t imported;
+    {
+        TickArchiveWriter writer(csv_archive);
+        imported = archive_accumulator_csv(csv_path, "SPY", writer);
+    }
+    TickArchiveReader csv_reader(csv_archive);
+    auto csv_ticks = csv_reader.read_all("SPY");
+    check("CSV rows archived with prices and timestamps intact",
+          imported == 3 && csv_ticks.size() == 3 && std::fabs(csv_ticks[2].price - 681.19) < 1e-9 &&
+          csv_ticks[1].timestamp_us - csv_ticks[0].timestamp_us == 15000000);
+
+    std::cout << "Test: Out-of-order ticks rejected\n";
+    bool rejected = false;
+    try {
+        TickArchiveWriter writer((dir / "bad.ticks").string());
+        writer.append("SPY", 2000000, 681.0);
+        writer.append("SPY", 1000000, 681.0);
+    } catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    check("Timestamp going backwards for a symbol throws", rejected);
+
+    std::cout << "Test: Bad arguments leave an existing archive intact\n";
+    bool bad_args_rejected = false;
+    try {
+        TickArchiveWriter writer(csv_archive, 12);
+    } catch (const std::invalid_argument&) {
+        bad_args_rejected = true;
+    }
+    TickArchiveReader survivor(csv_archive);
+    check("Invalid decimals throw before the file is truncated",
+          bad_args_rejected && survivor.read_all("SPY").size() == 3);
+
+    std::cout << "\n=== Decode Throughput ===\n";
+    TickArchiveReader bench(path);
+    size_t decoded_ticks = 0;
+    auto decode_start = std::chrono::steady_clock::now();
+    for (int rep = 0; rep < 5; ++rep) {
+        for (const auto& s : session) decoded_ticks += bench.read_all(s.symbol).size();
+    }
+    double decode_secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - decode_start).count();
+    std::cout << std::setprecision(1) << (decoded_ticks / decode_secs) / 1e6 << " M ticks/s, "
+              << (bench.bytes_decoded() / decode_secs) / 1e6 << " MB/s compressed\n";
+
+    fs::remove_all(dir);
+
+    std::cout << "\n=== Tick Archive Test Summary ===\n";
+    std::cout << "Tests passed: " << passed_tests << "/" << total_tests << "\n";
+    assert(passed_tests == total_tests);
+    std::cout << "✓ ALL TICK ARCHIVE TESTS PASSED\n";
+
+    return 0;
+}
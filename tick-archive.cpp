@@ -0,0 +1,359 @@
+// # Goal to keep years of multi-symbol ticks on one disk and read time ranges without scanning
+#include <vector>
+#include <string>
+#include <map>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <stdexcept>
+
+// File layout (all integers little endian):
+//   header  "SETICK01" | u8 price decimals
+//   blocks  one symbol each, independently decodable:
+//           varint count | zigzag first timestamp | zigzag first price
+//           then per tick: zigzag delta-of-delta timestamp | zigzag price delta
+//   index   varint symbols, (varint length, bytes) each
+//           varint blocks, (symbol id, first ts, last ts, offset, size, count) each as varints
+//   footer  u64 index offset | "SETIDX01"
+// Timestamps are microseconds since the epoch; prices are fixed point at `decimals`.
+
+struct Tick {
+    int64_t timestamp_us;
+    double price;
+};
+
+struct ArchiveBlock {
+    uint32_t symbol_id;
+    int64_t first_ts;
+    int64_t last_ts;
+    uint64_t offset;
+    uint64_t size;
+    uint32_t count;
+};
+
+namespace tick_archive_detail {
+
+constexpr char HEADER_MAGIC[8] = {'S', 'E', 'T', 'I', 'C', 'K', '0', '1'};
+constexpr char FOOTER_MAGIC[8] = {'S', 'E', 'T', 'I', 'D', 'X', '0', '1'};
+constexpr size_t HEADER_SIZE = 9;
+constexpr size_t FOOTER_SIZE = 16;
+
+inline uint64_t zigzag(int64_t v) { return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63); }
+inline int64_t unzigzag(uint64_t v) { return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1); }
+
+inline void put_varint(std::vector<uint8_t>& out, uint64_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<uint8_t>(v) | 0x80);
+        v >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+inline uint64_t get_varint(const uint8_t*& p, const uint8_t* end) {
+    uint64_t v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (p == end) throw std::runtime_error("tick archive: truncated varint");
+        uint8_t byte = *p++;
+        v |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) return v;
+    }
+    throw std::runtime_error("tick archive: malformed varint");
+}
+
+inline void put_u64(std::vector<uint8_t>& out, uint64_t v) {
+    for (int i = 0; i < 8; ++i) out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+}
+
+inline uint64_t get_u64(const uint8_t* p) {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; ++i) v |= static_cast<uint64_t>(p[i]) << (8 * i);
+    return v;
+}
+
+}  // namespace tick_archive_detail
+
+class TickArchiveWriter {
+public:
+    // Arguments are checked before the file is opened, so a bad call never truncates an existing archive.
+    TickArchiveWriter(const std::string& path, int decimals = 4, size_t block_ticks = 4096)
+        : decimals_(decimals), block_ticks_(block_ticks) {
+        if (decimals < 0 || decimals > 9) throw std::invalid_argument("tick archive: decimals must be in [0, 9]");
+        if (block_ticks == 0) throw std::invalid_argument("tick archive: block_ticks must be > 0");
+        out_.open(path, std::ios::binary | std::ios::trunc);
+        if (!out_) throw std::runtime_error("tick archive: cannot open " + path);
+        scale_ = std::pow(10.0, decimals_);
+        out_.write(tick_archive_detail::HEADER_MAGIC, 8);
+        out_.put(static_cast<char>(decimals_));
+        offset_ = tick_archive_detail::HEADER_SIZE;
+    }
+
+    ~TickArchiveWriter() {
+        try {
+            close();
+        } catch (...) {
+        }
+    }
+
+    // Ticks of one symbol must arrive in non-decreasing time order; symbols may interleave.
+    void append(const std::string& symbol, int64_t timestamp_us, double price) {
+        using namespace tick_archive_detail;
+        if (closed_) throw std::logic_error("tick archive: append after close");
+        Pending& b = pending_for(symbol);
+        int64_t fixed = std::llround(price * scale_);
+        if (b.count == 0) {
+            put_varint(b.bytes, zigzag(timestamp_us));
+            put_varint(b.bytes, zigzag(fixed));
+            b.first_ts = timestamp_us;
+            b.prev_delta = 0;
+        } else {
+            if (timestamp_us < b.prev_ts) {
+                throw std::invalid_argument("tick archive: out-of-order timestamp for " + symbol);
+            }
+            int64_t delta = timestamp_us - b.prev_ts;
+            put_varint(b.bytes, zigzag(delta - b.prev_delta));
+            put_varint(b.bytes, zigzag(fixed - b.prev_price));
+            b.prev_delta = delta;
+        }
+        b.prev_ts = timestamp_us;
+        b.prev_price = fixed;
+        if (++b.count == block_ticks_) flush(b);
+    }
+
+    void close() {
+        using namespace tick_archive_detail;
+        if (closed_) return;
+        closed_ = true;
+        for (auto& b : pending_) flush(b);
+
+        std::vector<uint8_t> index;
+        put_varint(index, symbols_.size());
+        for (const auto& s : symbols_) {
+            put_varint(index, s.size());
+            index.insert(index.end(), s.begin(), s.end());
+        }
+        put_varint(index, blocks_.size());
+        for (const auto& blk : blocks_) {
+            put_varint(index, blk.symbol_id);
+            put_varint(index, zigzag(blk.first_ts));
+            put_varint(index, zigzag(blk.last_ts));
+            put_varint(index, blk.offset);
+            put_varint(index, blk.size);
+            put_varint(index, blk.count);
+        }
+        put_u64(index, offset_);
+        index.insert(index.end(), FOOTER_MAGIC, FOOTER_MAGIC + 8);
+        out_.write(reinterpret_cast<const char*>(index.data()), index.size());
+        out_.close();
+        if (!out_) throw std::runtime_error("tick archive: write failed");
+    }
+
+    size_t blocks_written() const { return blocks_.size(); }
+
+private:
+    struct Pending {
+        uint32_t symbol_id = 0;
+        std::vector<uint8_t> bytes;
+        uint32_t count = 0;
+        int64_t first_ts = 0;
+        int64_t prev_ts = 0;
+        int64_t prev_delta = 0;
+        int64_t prev_price = 0;
+    };
+
+    std::ofstream out_;
+    int decimals_;
+    double scale_ = 1.0;
+    size_t block_ticks_;
+    uint64_t offset_ = 0;
+    bool closed_ = false;
+
+    std::vector<std::string> symbols_;
+    std::map<std::string, uint32_t> symbol_ids_;
+    std::vector<Pending> pending_;
+    std::vector<ArchiveBlock> blocks_;
+
+    Pending& pending_for(const std::string& symbol) {
+        auto it = symbol_ids_.find(symbol);
+        if (it != symbol_ids_.end()) return pending_[it->second];
+        uint32_t id = static_cast<uint32_t>(symbols_.size());
+        symbol_ids_.emplace(symbol, id);
+        symbols_.push_back(symbol);
+        pending_.emplace_back();
+        pending_.back().symbol_id = id;
+        return pending_.back();
+    }
+
+    void flush(Pending& b) {
+        using namespace tick_archive_detail;
+        if (b.count == 0) return;
+        std::vector<uint8_t> head;
+        put_varint(head, b.count);
+        out_.write(reinterpret_cast<const char*>(head.data()), head.size());
+        out_.write(reinterpret_cast<const char*>(b.bytes.data()), b.bytes.size());
+        if (!out_) throw std::runtime_error("tick archive: write failed");
+
+        uint64_t size = head.size() + b.bytes.size();
+        blocks_.push_back({b.symbol_id, b.first_ts, b.prev_ts, offset_, size, b.count});
+        offset_ += size;
+        b.bytes.clear();
+        b.count = 0;
+    }
+};
+
+class TickArchiveReader {
+public:
+    explicit TickArchiveReader(const std::string& path) : in_(path, std::ios::binary) {
+        using namespace tick_archive_detail;
+        if (!in_) throw std::runtime_error("tick archive: cannot open " + path);
+
+        char header[HEADER_SIZE];
+        in_.read(header, HEADER_SIZE);
+        if (!in_ || std::memcmp(header, HEADER_MAGIC, 8) != 0) throw std::runtime_error("tick archive: bad header");
+        decimals_ = static_cast<uint8_t>(header[8]);
+        scale_ = std::pow(10.0, decimals_);
+
+        in_.seekg(0, std::ios::end);
+        uint64_t file_size = static_cast<uint64_t>(in_.tellg());
+        if (file_size < HEADER_SIZE + FOOTER_SIZE) throw std::runtime_error("tick archive: truncated file");
+        uint8_t footer[FOOTER_SIZE];
+        in_.seekg(file_size - FOOTER_SIZE);
+        in_.read(reinterpret_cast<char*>(footer), FOOTER_SIZE);
+        if (!in_ || std::memcmp(footer + 8, FOOTER_MAGIC, 8) != 0) throw std::runtime_error("tick archive: bad footer");
+        uint64_t index_offset = get_u64(footer);
+        if (index_offset < HEADER_SIZE || index_offset > file_size - FOOTER_SIZE) {
+            throw std::runtime_error("tick archive: bad index offset");
+        }
+
+        std::vector<uint8_t> index(file_size - FOOTER_SIZE - index_offset);
+        in_.seekg(index_offset);
+        in_.read(reinterpret_cast<char*>(index.data()), index.size());
+        if (!in_) throw std::runtime_error("tick archive: cannot read index");
+
+        const uint8_t* p = index.data();
+        const uint8_t* end = p + index.size();
+        uint64_t num_symbols = get_varint(p, end);
+        for (uint64_t i = 0; i < num_symbols; ++i) {
+            uint64_t len = get_varint(p, end);
+            if (static_cast<uint64_t>(end - p) < len) throw std::runtime_error("tick archive: truncated index");
+            symbols_.emplace_back(reinterpret_cast<const char*>(p), len);
+            symbol_ids_[symbols_.back()] = static_cast<uint32_t>(i);
+            p += len;
+        }
+        by_symbol_.resize(num_symbols);
+        uint64_t num_blocks = get_varint(p, end);
+        blocks_.reserve(num_blocks);
+        for (uint64_t i = 0; i < num_blocks; ++i) {
+            ArchiveBlock blk;
+            blk.symbol_id = static_cast<uint32_t>(get_varint(p, end));
+            blk.first_ts = unzigzag(get_varint(p, end));
+            blk.last_ts = unzigzag(get_varint(p, end));
+            blk.offset = get_varint(p, end);
+            blk.size = get_varint(p, end);
+            blk.count = static_cast<uint32_t>(get_varint(p, end));
+            if (blk.symbol_id >= num_symbols || blk.offset + blk.size > index_offset) {
+                throw std::runtime_error("tick archive: bad index entry");
+            }
+            by_symbol_[blk.symbol_id].push_back(blocks_.size());
+            blocks_.push_back(blk);
+        }
+        // A symbol's blocks are flushed in time order, so each list is already sorted by first_ts.
+    }
+
+    // All ticks of `symbol` with from_us <= timestamp <= to_us; only overlapping blocks are read.
+    std::vector<Tick> query(const std::string& symbol, int64_t from_us, int64_t to_us) {
+        std::vector<Tick> out;
+        auto it = symbol_ids_.find(symbol);
+        if (it == symbol_ids_.end() || from_us > to_us) return out;
+        const auto& list = by_symbol_[it->second];
+        auto first = std::partition_point(list.begin(), list.end(),
+                                          [&](size_t b) { return blocks_[b].last_ts < from_us; });
+        for (auto b = first; b != list.end() && blocks_[*b].first_ts <= to_us; ++b) {
+            decode_block(blocks_[*b], from_us, to_us, out);
+        }
+        return out;
+    }
+
+    // Every tick of `symbol`, in time order
+    std::vector<Tick> read_all(const std::string& symbol) {
+        return query(symbol, INT64_MIN, INT64_MAX);
+    }
+
+    const std::vector<std::string>& symbols() const { return symbols_; }
+    const std::vector<ArchiveBlock>& blocks() const { return blocks_; }
+    int decimals() const { return decimals_; }
+    size_t blocks_decoded() const { return blocks_decoded_; }
+    uint64_t bytes_decoded() const { return bytes_decoded_; }
+
+private:
+    std::ifstream in_;
+    int decimals_ = 0;
+    double scale_ = 1.0;
+    std::vector<std::string> symbols_;
+    std::map<std::string, uint32_t> symbol_ids_;
+    std::vector<ArchiveBlock> blocks_;
+    std::vector<std::vector<size_t>> by_symbol_;
+    std::vector<uint8_t> buffer_;
+    size_t blocks_decoded_ = 0;
+    uint64_t bytes_decoded_ = 0;
+
+    void decode_block(const ArchiveBlock& blk, int64_t from_us, int64_t to_us, std::vector<Tick>& out) {
+        using namespace tick_archive_detail;
+        buffer_.resize(blk.size);
+        in_.seekg(blk.offset);
+        in_.read(reinterpret_cast<char*>(buffer_.data()), blk.size);
+        if (!in_) throw std::runtime_error("tick archive: cannot read block");
+        blocks_decoded_++;
+        bytes_decoded_ += blk.size;
+
+        const uint8_t* p = buffer_.data();
+        const uint8_t* end = p + buffer_.size();
+        uint64_t count = get_varint(p, end);
+        int64_t ts = unzigzag(get_varint(p, end));
+        int64_t price = unzigzag(get_varint(p, end));
+        int64_t delta = 0;
+        if (from_us <= ts && ts <= to_us) out.push_back({ts, price / scale_});
+        for (uint64_t i = 1; i < count; ++i) {
+            delta += unzigzag(get_varint(p, end));
+            ts += delta;
+            price += unzigzag(get_varint(p, end));
+            if (ts > to_us) break;
+            if (ts >= from_us) out.push_back({ts, price / scale_});
+        }
+    }
+};
+
+// "YYYY-MM-DD HH:MM:SS" in local time (as written by accumulator.cpp) to microseconds since the epoch
+int64_t parse_timestamp_us(const std::string& text) {
+    std::tm tm = {};
+    std::istringstream ss(text);
+    ss >> std::get_time(&tm, "%Y-%m-%d %H:%M:%S");
+    if (ss.fail()) throw std::invalid_argument("tick archive: bad timestamp '" + text + "'");
+    tm.tm_isdst = -1;
+    return static_cast<int64_t>(std::mktime(&tm)) * 1000000;
+}
+
+// Move a single-symbol CSV in accumulator.cpp's layout (Timestamp,Price,High,Low,Open,PrevClose)
+// into the archive, tagging every row with `symbol`. The layout has no symbol column, so the caller
+// must know the file holds one symbol only: the tests/spy_live_data.csv that collect_multi.sh builds
+// interleaves SPY/QQQ/AAPL/TSLA quotes and cannot be split here. Returns the number of ticks archived.
+size_t archive_accumulator_csv(const std::string& csv_path, const std::string& symbol, TickArchiveWriter& writer) {
+    std::ifstream csv(csv_path);
+    if (!csv) throw std::runtime_error("tick archive: cannot open " + csv_path);
+    std::string line;
+    std::getline(csv, line);  // header
+    size_t archived = 0;
+    while (std::getline(csv, line)) {
+        size_t comma = line.find(',');
+        if (comma == std::string::npos) continue;
+        size_t next = line.find(',', comma + 1);
+        double price = std::stod(line.substr(comma + 1, next - comma - 1));
+        writer.append(symbol, parse_timestamp_us(line.substr(0, comma)), price);
+        archived++;
+    }
+    return archived;
+}